@@ -8,12 +8,20 @@ EPSILON = 10e-10
 
 parser = argparse.ArgumentParser()
 parser.add_argument('-v', '--verbose', action='store_true')
+parser.add_argument('-e', '--epsilon', type=float, default=EPSILON,
+                    help='maximum relative difference allowed between values')
+parser.add_argument('-r', '--report', action='store_true',
+                    help='report the maximum relative difference of each '
+                    'column, instead of stopping at the first mismatch '
+                    '(e.g. to compare single- and double-precision runs)')
 parser.add_argument('f1', type=argparse.FileType('r'))
 parser.add_argument('f2', type=argparse.FileType('r'))
 args = parser.parse_args()
 
 lineno = 0
+header = []
 maxdiff = [0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0]
+mismatches = 0
 for (l1,l2) in itertools.izip_longest(args.f1, args.f2):
     lineno += 1
     if l2 is None:
@@ -29,9 +37,9 @@ for (l1,l2) in itertools.izip_longest(args.f1, args.f2):
         sys.exit(1)
     # Skip header
     if lineno == 1:
+        header = l1.rstrip('\n').split('\t')
         continue
-    tokidx = 0
-    for (x1,x2) in zip(toks1, toks2):
+    for (tokidx,(x1,x2)) in enumerate(zip(toks1, toks2)):
         # Skip wall-clock time column
         if tokidx == 2:
             continue
@@ -39,9 +47,17 @@ for (l1,l2) in itertools.izip_longest(args.f1, args.f2):
         x2 = float(x2)
         reldiff = abs((x1-x2)/x1) if x1 != 0.0 else x2
         maxdiff[tokidx] = max(maxdiff[tokidx], reldiff)
-        if reldiff > EPSILON:
-            print 'Line %s, Column %s: %s vs %s' % (lineno, tokidx, x1, x2)
-            sys.exit(1)
-        tokidx += 1
+        if reldiff > args.epsilon:
+            mismatches += 1
+            if not args.report:
+                print 'Line %s, Column %s: %s vs %s' % (lineno, tokidx, x1, x2)
+                sys.exit(1)
+if args.report:
+    for (tokidx,diff) in enumerate(maxdiff):
+        if tokidx == 2 or tokidx >= len(header):
+            continue
+        print '%-16s %e' % (header[tokidx], diff)
+    print '%s value(s) differ by more than %e' % (mismatches, args.epsilon)
+    sys.exit(1 if mismatches > 0 else 0)
 if args.verbose:
     print 'Max differences: %s' % maxdiff
@@ -16,6 +16,15 @@ Exports.ParticlesBC = Enum('Periodic','Bounce','Disappear')
 Exports.ViscosityModel = Enum('Constant','PowerLaw','Sutherland')
 Exports.FlowInitCase = Enum('Uniform','Random','Restart','Perturbed','TaylorGreen2DVortex','TaylorGreen3DVortex')
 Exports.ParticlesInitCase = Enum('Random','Restart','Uniform')
+-- Atomic: particles update their cells directly, with atomic reductions
+-- Binned: particles are first binned by cell, then each cell sums up the
+--         contributions of its own particles
+Exports.ParticlesDeposition = Enum('Atomic','Binned')
+-- PerDirection: particles are assigned their slots on each transfer queue
+--               through a separate prefix sum over the tile (can run on GPUs)
+-- CountingSort: particles are binned into all transfer queues at once, with a
+--               constant number of sweeps over the tile (CPU only)
+Exports.TradeQueueBinning = Enum('PerDirection','CountingSort')
 Exports.TempProfile = Union{
   Constant = {
     temperature = double,
@@ -47,12 +56,42 @@ Exports.TurbForcingModel = Union{
     K_o = double,
   },
 }
+-- OFF: the flow is solved, coupled to the particles
+-- Static: the initial flow field is held fixed
+-- Sequence: the flow field is held fixed, but is replaced every
+--           everyTimeSteps timesteps by the fluid_iter<timestep> snapshot
+--           under dir (as dumped by a run with the same grid and tiling)
+-- In the frozen modes only the particles and radiation are advanced, and the
+-- particles do not feed back into the flow.
+Exports.FrozenFlowModel = Union{
+  OFF = {},
+  Static = {},
+  Sequence = {
+    dir = String(256),
+    everyTimeSteps = int,
+  },
+}
 Exports.FeedModel = Union{
   OFF = {},
   Incoming = {
     addedVelocity = Array(3,double),
   },
 }
+-- OFF: parcels keep the size they were created with
+-- Budget: parcels are periodically merged or split, to keep the number of
+--         parcels on each tile close to a target
+Exports.ParcelManagement = Union{
+  OFF = {},
+  Budget = {
+    -- target number of parcels per tile, as a fraction of the tile's even
+    -- share of maxNum/parcelSize
+    budgetFraction = double,
+    -- maximum relative difference in diameter between merged parcels
+    diameterTolerance = double,
+    -- how often to merge/split parcels
+    everyTimeSteps = int,
+  },
+}
 Exports.RadiationModel = Union{
   OFF = {},
   Algebraic = {
@@ -118,6 +157,10 @@ Exports.Config = {
     outDir = String(256),
     -- expected wall-clock execution time [minutes]
     wallTime = int,
+    -- recompute the velocity gradients of each tile's halo cells within the
+    -- flux kernels, rather than exchanging them between tiles, so that each RK
+    -- sub-step needs a single halo exchange
+    deepHalo = bool,
   },
   Grid = {
     -- number of cells in the fluid grid
@@ -159,9 +202,17 @@ Exports.Config = {
     startTime = double,
     maxIter = int,
     cfl = double,
+    -- if positive, compute the timestep of each iteration from the state at the
+    -- start of the previous one (rather than the current one), scaled down by
+    -- this safety factor [0.0-1.0]; this lets the runtime overlap consecutive
+    -- iterations (0.0 disables lagging)
+    cflLagSafetyFactor = double,
     fixedDeltaTime = double,
     -- what order RK method to use [2-4]
     rkOrder = int,
+    -- use a low-storage (2N) RK method of the requested order [3-4], which
+    -- keeps a single extra register per conserved variable, instead of two
+    lowStorage = bool,
   },
   Flow = {
     gasConstant = double,
@@ -179,6 +230,7 @@ Exports.Config = {
     initParams = Array(6,double),
     bodyForce = Array(3,double),
     turbForcing = Exports.TurbForcingModel,
+    frozen = Exports.FrozenFlowModel,
   },
   Particles = {
     initCase = Exports.ParticlesInitCase,
@@ -193,12 +245,40 @@ Exports.Config = {
     diameterMean = double,
     bodyForce = Array(3,double),
     maxSkew = double,
+    -- rebalance particle storage across tiles when the free slots of the
+    -- fullest tile fall below this fraction of the average free slots per tile
+    -- (0.0 disables rebalancing)
+    rebalanceThreshold = double,
     escapeRatioPerDir = double,
+    -- number of rounds of the particle exchange on each sub-step; particles
+    -- that don't fit in the transfer queues are sent on the next round
+    maxTradeRounds = int,
+    -- how particles moving to other tiles are placed on the transfer queues
+    tradeQueueBinning = Exports.TradeQueueBinning,
     collisions = bool,
+    -- fraction of a tile's particles that may lie within collision range of
+    -- each neighboring tile (is raised to the number of directions for
+    -- edge/corner neighbors)
+    collisionHaloRatioPerDir = double,
     feeding = Exports.FeedModel,
-    -- how many timesteps to advance the fluid before every particle solve
+    -- how many timesteps to advance the fluid before every particle solve (the
+    -- maximum, if the stride is chosen adaptively)
     staggerFactor = int,
+    -- if positive, each particle is advanced every 2^k fluid timesteps, where
+    -- 2^k is the largest power of two (up to staggerFactor) for which the
+    -- particle's timestep is at most this fraction of its relaxation time
+    -- (0.0 advances all particles every staggerFactor fluid timesteps)
+    staggerRelaxationFraction = double,
+    -- number of physical particles represented by each parcel, at creation
     parcelSize = int,
+    parcelManagement = Exports.ParcelManagement,
+    -- how often to reorder each tile's particles by cell, for locality of
+    -- access to the fluid (0 disables); only applies to timesteps on which the
+    -- particles are advanced
+    sortEveryTimeSteps = int,
+    -- how particles deposit their contributions to the fluid and radiation
+    -- grids
+    deposition = Exports.ParticlesDeposition,
   },
   Radiation = Exports.RadiationModel,
   IO = {
@@ -103,6 +103,7 @@ public:
   class Tiling3DFunctor;
   class Tiling2DFunctor;
   class HardcodedFunctor;
+  class RankFunctor;
 
 public:
   SampleMapping(Runtime* rt, const Config& config, AddressSpace first_rank)
@@ -122,7 +123,8 @@ public:
                           {new Tiling2DFunctor(rt, *this, 1, false),
                            new Tiling2DFunctor(rt, *this, 1, true )},
                           {new Tiling2DFunctor(rt, *this, 2, false),
-                           new Tiling2DFunctor(rt, *this, 2, true )}} {
+                           new Tiling2DFunctor(rt, *this, 2, true )}},
+      rank_functor_(new RankFunctor(rt, *this)) {
     for (unsigned x = 0; x < x_tiles(); ++x) {
       for (unsigned y = 0; y < y_tiles(); ++y) {
         for (unsigned z = 0; z < z_tiles(); ++z) {
@@ -161,6 +163,15 @@ public:
     assert(0 <= dim && dim < 3);
     return tiling_2d_functors_[dim][dir];
   }
+  RankFunctor* rank_functor() {
+    return rank_functor_;
+  }
+  DomainPoint rank_of_tile(const DomainPoint& tile) const {
+    assert(tile.get_dim() == 3);
+    return Point<3>(tile[0] / tiles_per_rank_[0],
+                    tile[1] / tiles_per_rank_[1],
+                    tile[2] / tiles_per_rank_[2]);
+  }
   HardcodedFunctor* hardcoded_functor(const DomainPoint& tile) {
     assert(tile.get_dim() == 3);
     assert(0 <= tile[0] && tile[0] < x_tiles());
@@ -264,6 +275,31 @@ public:
     DomainPoint tile_;
   };
 
+  // Maps tasks in a 3D index space launch over ranks (rather than tiles), to
+  // the first splinter of the corresponding shard.
+  class RankFunctor : public SplinteringFunctor {
+  public:
+    RankFunctor(Runtime* rt, SampleMapping& parent)
+      : SplinteringFunctor(rt, parent) {}
+  public:
+    virtual ShardID shard(const DomainPoint& point,
+                          const Domain& full_space,
+                          const size_t total_shards) {
+      assert(point.get_dim() == 3);
+      CHECK(0 <= point[0] && point[0] < parent_.ranks_per_dim_[0] &&
+            0 <= point[1] && point[1] < parent_.ranks_per_dim_[1] &&
+            0 <= point[2] && point[2] < parent_.ranks_per_dim_[2],
+            "Unexpected point on index space launch");
+      return
+        point[0] * parent_.ranks_per_dim_[1] * parent_.ranks_per_dim_[2] +
+        point[1] * parent_.ranks_per_dim_[2] +
+        point[2];
+    }
+    virtual SplinterID splinter(const DomainPoint &point) {
+      return 0;
+    }
+  };
+
 private:
   unsigned tiles_per_rank_[3];
   unsigned ranks_per_dim_[3];
@@ -271,6 +307,7 @@ private:
   Tiling3DFunctor* tiling_3d_functor_;
   Tiling2DFunctor* tiling_2d_functors_[3][2];
   std::vector<HardcodedFunctor*> hardcoded_functors_;
+  RankFunctor* rank_functor_;
 };
 
 AddressSpace SplinteringFunctor::get_rank(const DomainPoint &point) {
@@ -453,8 +490,15 @@ private:
 
   SplinteringFunctor* pick_functor(const MapperContext ctx,
                                    const Task& task) {
+    // 3D index space tasks launched over ranks
+    if (task.is_index_space &&
+        EQUALS(task.get_task_name(), "Particles_MigrateWithinRank")) {
+      unsigned sample_id = find_sample_id(ctx, task);
+      SampleMapping& mapping = sample_mappings_[sample_id];
+      return mapping.rank_functor();
+    }
     // 3D index space tasks
-    if (task.is_index_space && task.index_domain.get_dim() == 3) {
+    else if (task.is_index_space && task.index_domain.get_dim() == 3) {
       unsigned sample_id = find_sample_id(ctx, task);
       SampleMapping& mapping = sample_mappings_[sample_id];
       return mapping.tiling_3d_functor();
@@ -653,8 +697,8 @@ public:
     // Increase priority of tasks on the critical path of the fluid solve.
     if (STARTS_WITH(task.get_task_name(), "Flow_ComputeVelocityGradient") ||
         STARTS_WITH(task.get_task_name(), "Flow_UpdateGhostVelocityGradient") ||
-        STARTS_WITH(task.get_task_name(), "Flow_GetFlux") ||
-        STARTS_WITH(task.get_task_name(), "Flow_UpdateUsingFlux")) {
+        STARTS_WITH(task.get_task_name(), "Flow_UpdateUsingFlux") ||
+        STARTS_WITH(task.get_task_name(), "Flow_AddFluxDivergence")) {
       priority = 1;
     }
     return priority;
@@ -679,6 +723,42 @@ public:
     output.chosen_functor = mapping.hardcoded_functor(Point<3>(0,0,0))->id;
   }
 
+  // Shard each dependent partitioning operation (used to partition the
+  // particles according to their current storage layout, and the transfer
+  // queues down to their occupied entries) the same way as an index space
+  // launch over its color space, i.e. over tiles or over ranks, so that each
+  // rank computes the subregions it will be using.
+  // NOTE: Will only run if Legion is compiled with dynamic control replication.
+  virtual void select_sharding_functor(const MapperContext ctx,
+                                       const Partition& partition,
+                                       const SelectShardingFunctorInput& input,
+                                       SelectShardingFunctorOutput& output) {
+    CHECK(partition.parent_task != NULL &&
+          (EQUALS(partition.parent_task->get_task_name(), "workDual") ||
+           EQUALS(partition.parent_task->get_task_name(), "workSingle")) &&
+          partition.is_index_space &&
+          partition.index_domain.get_dim() == 3,
+          "Unexpected argument on partition");
+    const RegionRequirement& req = partition.requirement;
+    LogicalRegion region = req.region.exists() ? req.region
+      : runtime->get_parent_logical_region(ctx, req.partition);
+    region = get_root(ctx, region);
+    const void* info = NULL;
+    size_t info_size = 0;
+    bool success = runtime->retrieve_semantic_information
+      (ctx, region, SAMPLE_ID_TAG, info, info_size,
+       false/*can_fail*/, true/*wait_until_ready*/);
+    CHECK(success, "Missing SAMPLE_ID_TAG semantic information on region");
+    assert(info_size == sizeof(unsigned));
+    unsigned sample_id = *static_cast<const unsigned*>(info);
+    assert(sample_id < sample_mappings_.size());
+    SampleMapping& mapping = sample_mappings_[sample_id];
+    output.chosen_functor =
+      (partition.index_domain.get_volume() == mapping.num_ranks())
+      ? mapping.rank_functor()->id
+      : mapping.tiling_3d_functor()->id;
+  }
+
 //=============================================================================
 // MAPPER CLASS: MINOR OVERRIDES
 //=============================================================================
@@ -698,6 +778,9 @@ public:
   // Disable an optimization done by the default mapper (attempts to reuse an
   // instance that covers a superset of the requested index space, by searching
   // higher up the partition tree).
+  // The only exception are the tiles of a Particles region: when they reside in
+  // system memory, all the tiles assigned to the same rank share an instance,
+  // so that particles can migrate between them without any copies.
   virtual LogicalRegion default_policy_select_instance_region(
                               MapperContext ctx,
                               Memory target_memory,
@@ -705,7 +788,49 @@ public:
                               const LayoutConstraintSet& constraints,
                               bool force_new_instances,
                               bool meets_constraints) {
-    return req.region;
+    LogicalRegion region = req.region;
+    if (target_memory.kind() != Memory::SYSTEM_MEM ||
+        !runtime->has_parent_logical_partition(ctx, region)) {
+      return region;
+    }
+    LogicalPartition part = runtime->get_parent_logical_partition(ctx, region);
+    LogicalRegion root = runtime->get_parent_logical_region(ctx, part);
+    if (runtime->has_parent_logical_partition(ctx, root)) {
+      return region;
+    }
+    const void* info = NULL;
+    size_t info_size = 0;
+    if (!runtime->retrieve_semantic_information
+          (ctx, root, PARTICLES_BY_RANK_TAG, info, info_size,
+           true/*can_fail*/, false/*wait_until_ready*/)) {
+      return region;
+    }
+    assert(info_size == sizeof(Color));
+    Color by_rank_color = *static_cast<const Color*>(info);
+    bool success = runtime->retrieve_semantic_information
+      (ctx, root, PARTICLES_BY_TILE_TAG, info, info_size,
+       false/*can_fail*/, true/*wait_until_ready*/);
+    CHECK(success, "Missing PARTICLES_BY_TILE_TAG semantic information on region");
+    assert(info_size == sizeof(Color));
+    Color by_tile_color = *static_cast<const Color*>(info);
+    // Only the current by-tile partition is backed by the by-rank instances
+    // (the particles are re-partitioned when their storage is rebalanced).
+    if (runtime->get_logical_partition_color(ctx, part) != by_tile_color) {
+      return region;
+    }
+    DomainPoint tile = runtime->get_logical_region_color_point(ctx, region);
+    assert(tile.get_dim() == 3);
+    success = runtime->retrieve_semantic_information
+      (ctx, root, SAMPLE_ID_TAG, info, info_size,
+       false/*can_fail*/, true/*wait_until_ready*/);
+    CHECK(success, "Missing SAMPLE_ID_TAG semantic information on region");
+    unsigned sample_id = *static_cast<const unsigned*>(info);
+    assert(sample_id < sample_mappings_.size());
+    const SampleMapping& mapping = sample_mappings_[sample_id];
+    LogicalPartition by_rank =
+      runtime->get_logical_partition_by_color(ctx, root, by_rank_color);
+    return runtime->get_logical_subregion_by_color
+      (ctx, by_rank, mapping.rank_of_tile(tile));
   }
 
   // Disable an optimization done by the default mapper (extends the set of
@@ -737,12 +862,6 @@ public:
                                        SelectShardingFunctorOutput& output) {
     CHECK(false, "Unsupported: Sharded Release");
   }
-  virtual void select_sharding_functor(const MapperContext ctx,
-                                       const Partition& partition,
-                                       const SelectShardingFunctorInput& input,
-                                       SelectShardingFunctorOutput& output) {
-    CHECK(false, "Unsupported: Sharded Partition");
-  }
   virtual void select_sharding_functor(const MapperContext ctx,
                                        const MustEpoch& epoch,
                                        const SelectShardingFunctorInput& input,
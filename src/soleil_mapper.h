@@ -6,7 +6,14 @@ extern "C" {
 #endif
 
 enum {
-  SAMPLE_ID_TAG = 12345
+  SAMPLE_ID_TAG = 12345,
+  // Attached to a sample's Particles region, if multiple tiles are assigned to
+  // each rank; holds the color of the partition that groups tiles by rank.
+  PARTICLES_BY_RANK_TAG = 12346,
+  // Attached alongside PARTICLES_BY_RANK_TAG; holds the color of the partition
+  // that splits the Particles region by tile. Both tags are updated whenever
+  // particle storage is rebalanced.
+  PARTICLES_BY_TILE_TAG = 12347
 };
 
 void register_mappers();